@@ -37,6 +37,7 @@
 #include "utils.h"
 #include "options.h"
 #include "optimize.h"
+#include "run_cache.h"
 
 #include <scgms/rtl/scgmsLib.h>
 #include <scgms/rtl/FilterLib.h>
@@ -77,7 +78,18 @@ void MainCalling sighandler(int signo) {
 	}
 }
 
-int Execute_Configuration(scgms::SPersistent_Filter_Chain_Configuration configuration, const bool save_config) {
+int Execute_Configuration(scgms::SPersistent_Filter_Chain_Configuration configuration, const TAction& action) {
+
+	//bit-identical execution with unchanged inputs and libraries may have been done already
+	TRun_Cache_Key run_cache_key;
+	const bool use_run_cache = !action.run_cache_dir.empty() && Prepare_Run_Cache_Key(action.run_cache_dir, configuration, action, {}, run_cache_key);
+	if (use_run_cache) {
+		TRun_Cache_Result cached_result;
+		if (Lookup_Run_Cache(run_cache_key, 0, cached_result)) {
+			std::wcout << L"Restored the outputs from run cache entry " << run_cache_key.entry_path.wstring() << std::endl;
+			return 0;
+		}
+	}
 
 	refcnt::Swstr_list errors;
 	Global_Filter_Executor = scgms::SFilter_Executor{ configuration.get(),
@@ -101,7 +113,7 @@ int Execute_Configuration(scgms::SPersistent_Filter_Chain_Configuration configur
 	// wait for filters to finish, or user to close the app
 	Global_Filter_Executor->Terminate(TRUE);
 
-	if (save_config) {
+	if (action.save_config) {
 		std::wcout << L"Saving configuration...";
 		errors = refcnt::Swstr_list{};
 		const HRESULT rc = configuration->Save_To_File(nullptr, errors.get());
@@ -119,6 +131,16 @@ int Execute_Configuration(scgms::SPersistent_Filter_Chain_Configuration configur
 		}
 	}
 
+	//an interrupted execution did not produce the complete outputs
+	if (use_run_cache && (Global_Progress.cancelled == 0)) {
+		if (Store_Run_Cache(run_cache_key, TRun_Cache_Result{})) {
+			std::wcout << L"Outputs stored to run cache entry " << run_cache_key.entry_path.wstring() << std::endl;
+		}
+		else {
+			std::wcerr << L"Failed to store the outputs to the run cache!" << std::endl;
+		}
+	}
+
 	return 0;
 }
 
@@ -147,7 +169,7 @@ int MainCalling main(int argc, char** argv) {
 
 		switch (action_to_do.action) {
 			case NAction::execute:
-				result = Global_Progress.cancelled == 0 ? Execute_Configuration(configuration, action_to_do.save_config) : __LINE__;
+				result = Global_Progress.cancelled == 0 ? Execute_Configuration(configuration, action_to_do) : __LINE__;
 				break;
 			case NAction::optimize:
 				result = Global_Progress.cancelled == 0 ? Optimize_Configuration(configuration, action_to_do, Global_Progress) : __LINE__;
@@ -37,51 +37,132 @@
 #include "optimize.h"
 
 #include "utils.h"
+#include "run_cache.h"
 #include <scgms/utils/string_utils.h>
 #include <scgms/utils/system_utils.h>
 
 #include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
 
-int Optimize_Configuration(scgms::SPersistent_Filter_Chain_Configuration configuration, const TAction& action, solver::TSolver_Progress& progress) {
+//time and progress of the recently written record, so that the throughput since then can be reported
+struct TTelemetry_Mark {
+	double elapsed_seconds = 0.0;
+	size_t progress = 0;
+};
 
-	const size_t optimize_param_count = action.parameters_to_optimize.size();
-	if (optimize_param_count < 1) {
-		std::wcerr << L"Have no parameters to optimize!\n";
-		return __LINE__;
-	}
+//writes a single JSON object per line; non-finite numbers are written as null, as JSON cannot express them
+static void Write_Telemetry_Record(std::ofstream& telemetry, const double elapsed_seconds, const solver::TSolver_Progress& progress, const char* stage, const char* state, TTelemetry_Mark& recent_mark) {
+	auto write_number = [&telemetry](const double value) {
+		if (std::isfinite(value)) {
+			telemetry << value;
+		}
+		else {
+			telemetry << "null";
+		}
+	};
 
-	std::vector<size_t> optimize_param_indices;
-	std::vector<const wchar_t*> optimize_param_names;
+	const size_t current_progress = progress.current_progress;
 
-	for (const auto& param : action.parameters_to_optimize) {
-		optimize_param_indices.push_back(param.index);
-		optimize_param_names.push_back(param.name.c_str());
+	telemetry << "{\"elapsed_s\":";
+	write_number(elapsed_seconds);
+	telemetry << ",\"stage\":\"" << stage << "\"";
+	telemetry << ",\"state\":\"" << state << "\"";
+	telemetry << ",\"progress\":" << current_progress;
+	telemetry << ",\"max_progress\":" << progress.max_progress;
+	//mean rate since the start, and the rate since the recent record, which shows how the throughput changes during the run
+	telemetry << ",\"mean_progress_per_s\":";
+	write_number(elapsed_seconds > 0.0 ? static_cast<double>(current_progress) / elapsed_seconds : std::numeric_limits<double>::quiet_NaN());
+	const double interval_seconds = elapsed_seconds - recent_mark.elapsed_seconds;
+	telemetry << ",\"interval_progress_per_s\":";
+	write_number((interval_seconds > 0.0) && (current_progress >= recent_mark.progress) ? static_cast<double>(current_progress - recent_mark.progress) / interval_seconds : std::numeric_limits<double>::quiet_NaN());
+	telemetry << ",\"best_fitness\":[";
+	for (size_t i = 0; i < solver::Maximum_Objectives_Count; i++) {
+		if (i > 0) {
+			telemetry << ',';
+		}
+		write_number(progress.best_metric[i]);
 	}
+	telemetry << "]}" << std::endl;	//flush, so that the stream can be followed while the optimization runs
 
-	const auto [hint_rc, expected_param_size] = Count_Parameters_Size(configuration, action.parameters_to_optimize);
-	if (hint_rc != S_OK) {
-		return __LINE__;
+	recent_mark.elapsed_seconds = elapsed_seconds;
+	recent_mark.progress = current_progress;
+}
+
+// true, if the candidate is nowhere worse than the reference and better in at least one objective; NaN is worse than any number
+static bool Dominates(const solver::TFitness& candidate, const solver::TFitness& reference) {
+	bool better_somewhere = false;
+	for (size_t i = 0; i < solver::Maximum_Objectives_Count; i++) {
+		const bool candidate_nan = std::isnan(candidate[i]);
+		const bool reference_nan = std::isnan(reference[i]);
+		if (candidate_nan && reference_nan) {
+			continue;
+		}
+
+		if (candidate_nan || (!reference_nan && (candidate[i] > reference[i]))) {
+			return false;
+		}
+
+		if (reference_nan || (candidate[i] < reference[i])) {
+			better_somewhere = true;
+		}
 	}
 
-	std::vector<std::vector<double>> hints;
-	//load hints
-	if (!Load_Hints(action.hints_to_load, expected_param_size, false, hints)) {
-		return __LINE__;
+	return better_somewhere;
+}
+
+static int Save_Optimized_Configuration(scgms::SPersistent_Filter_Chain_Configuration& configuration, const TAction& action, const solver::TSolver_Progress& progress, const TRun_Cache_Key* run_cache_key, const bool restored_from_cache) {
+	std::wcout << L"\nResulting fitness:";
+	for (size_t i = 0; i < solver::Maximum_Objectives_Count; i++) {
+		std::wcout << L' ' << i << L':' << progress.best_metric[i];
 	}
 
-	//load parameters
-	if (!Load_Hints(action.hinting_parameters_to_load, expected_param_size, true, hints)) {
-		return __LINE__;
+	if (run_cache_key) {
+		TRun_Cache_Result result;
+		result.fitness = progress.best_metric;
+		if (Read_Parameters_To_Optimize(configuration, action.parameters_to_optimize, result.parameters) && Store_Run_Cache(*run_cache_key, result)) {
+			std::wcout << L"\nParameters stored to run cache entry " << run_cache_key->entry_path.wstring();
+		}
+		else {
+			std::wcerr << std::endl << L"Failed to store the parameters to the run cache!" << std::endl;
+		}
 	}
 
-	std::vector<const double*> hints_ptr;
-	for (size_t i = 0; i < hints.size(); i++) {
-		hints_ptr.push_back(hints[i].data());
+	if (restored_from_cache) {
+		std::wcout << L"\nParameters were restored from the run cache, saving...";
+	}
+	else {
+		std::wcout << L"\nParameters were succesfully optimized, saving...";
 	}
 
 	refcnt::Swstr_list errors;
+	const HRESULT rc = configuration->Save_To_File(nullptr, errors.get());
+	errors.for_each([](auto str) {
+		std::wcerr << str << std::endl;
+	});
 
-	CPriority_Guard priority_guard;
+	if (!Succeeded(rc)) {
+		std::wcerr << std::endl << L"Failed to save optimized parameters!" << std::endl;
+		return __LINE__;
+	}
+	else {
+		std::wcout << L" saved." << std::endl;
+	}
+
+	return 0;
+}
+
+static HRESULT Run_Solver_Stage(scgms::SPersistent_Filter_Chain_Configuration& configuration, std::vector<size_t>& optimize_param_indices, std::vector<const wchar_t*>& optimize_param_names,
+	const GUID& solver_id, const size_t population_size, const size_t generation_count, std::vector<const double*>& hints_ptr,
+	solver::TSolver_Progress& progress, refcnt::Swstr_list& errors, std::ofstream& telemetry, const char* stage) {
+
+	//telemetry times are relative to the start of the stage, as the progress restarts with each stage
+	const auto start_time = std::chrono::steady_clock::now();
+	auto elapsed_seconds = [&start_time]() {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+	};
 
 	HRESULT rc = E_FAIL;
 	std::atomic<bool> optimizing_flag{ true };
@@ -89,14 +170,14 @@ int Optimize_Configuration(scgms::SPersistent_Filter_Chain_Configuration configu
 		//use thread, not async because that could live-lock on a uniprocessor
 
 		rc = scgms::Optimize_Parameters(configuration,
-			optimize_param_indices.data(), optimize_param_names.data(), optimize_param_count,
+			optimize_param_indices.data(), optimize_param_names.data(), optimize_param_indices.size(),
 #ifndef DDO_NOT_USE_QT
 			Setup_Filter_DB_Access,
 #else
 			nullptr,
 #endif
 			nullptr,
-			action.solver_id, action.population_size, action.generation_count,
+			solver_id, population_size, generation_count,
 			hints_ptr.data(), hints_ptr.size(),
 			progress, errors);
 
@@ -107,7 +188,27 @@ int Optimize_Configuration(scgms::SPersistent_Filter_Chain_Configuration configu
 	solver::TFitness recent_fitness = solver::Max_Fitness;
 	std::wcout << "Will report progress and best fitness. Optimizing...";
 
+	size_t recent_telemetry_progress = std::numeric_limits<size_t>::max();
+	solver::TFitness recent_telemetry_fitness = solver::Nan_Fitness;
+	TTelemetry_Mark recent_telemetry_mark{ elapsed_seconds(), 0 };
+
 	while (optimizing_flag) {
+		if (telemetry.is_open()) {
+			bool changed = recent_telemetry_progress != progress.current_progress;
+			for (size_t i = 0; i < solver::Maximum_Objectives_Count; i++) {
+				const double tmp_best = progress.best_metric[i];
+				if ((recent_telemetry_fitness[i] != tmp_best) && !(std::isnan(recent_telemetry_fitness[i]) && std::isnan(tmp_best))) {
+					recent_telemetry_fitness[i] = tmp_best;
+					changed = true;
+				}
+			}
+
+			if (changed) {
+				recent_telemetry_progress = progress.current_progress;
+				Write_Telemetry_Record(telemetry, elapsed_seconds(), progress, stage, "running", recent_telemetry_mark);
+			}
+		}
+
 		if (progress.max_progress != 0) {
 			double current_percentage = static_cast<double>(progress.current_progress) / static_cast<double>(progress.max_progress);
 			current_percentage = std::trunc(current_percentage * 1000.0);
@@ -138,29 +239,148 @@ int Optimize_Configuration(scgms::SPersistent_Filter_Chain_Configuration configu
 		optimitizing_thread.join();
 	}
 
-	errors.for_each([](auto str) {
-		std::wcerr << str << std::endl;
-	});
+	if (telemetry.is_open()) {
+		const char* final_state = (rc == S_OK) ? "improved" : (rc == S_FALSE) ? "not_improved" : "failed";
+		Write_Telemetry_Record(telemetry, elapsed_seconds(), progress, stage, final_state, recent_telemetry_mark);
+	}
 
-	if (rc == S_OK) {
-		std::wcout << L"\nResulting fitness:";
-		for (size_t i = 0; i < solver::Maximum_Objectives_Count; i++) {
-			std::wcout << L' ' << i << L':' << progress.best_metric[i];
+	return rc;
+}
+
+int Optimize_Configuration(scgms::SPersistent_Filter_Chain_Configuration configuration, const TAction& action, solver::TSolver_Progress& progress) {
+
+	const size_t optimize_param_count = action.parameters_to_optimize.size();
+	if (optimize_param_count < 1) {
+		std::wcerr << L"Have no parameters to optimize!\n";
+		return __LINE__;
+	}
+
+	std::vector<size_t> optimize_param_indices;
+	std::vector<const wchar_t*> optimize_param_names;
+
+	for (const auto& param : action.parameters_to_optimize) {
+		optimize_param_indices.push_back(param.index);
+		optimize_param_names.push_back(param.name.c_str());
+	}
+
+	const auto [hint_rc, expected_param_size] = Count_Parameters_Size(configuration, action.parameters_to_optimize);
+	if (hint_rc != S_OK) {
+		return __LINE__;
+	}
+
+	std::vector<std::vector<double>> hints;
+	//load hints
+	if (!Load_Hints(action.hints_to_load, expected_param_size, false, hints)) {
+		return __LINE__;
+	}
+
+	//load parameters
+	if (!Load_Hints(action.hinting_parameters_to_load, expected_param_size, true, hints)) {
+		return __LINE__;
+	}
+
+	//the same hint may come from multiple files; each duplicate would cost a full evaluation of the chain
+	const size_t duplicate_hints_count = Remove_Duplicate_Hints(hints);
+	if (duplicate_hints_count > 0) {
+		std::wcout << L"Removed " << duplicate_hints_count << L" duplicate hints, " << hints.size() << L" hints remain." << std::endl;
+	}
+
+	//bit-identical optimization with unchanged inputs and libraries may have been run already
+	TRun_Cache_Key run_cache_key;
+	const bool use_run_cache = !action.run_cache_dir.empty() && Prepare_Run_Cache_Key(action.run_cache_dir, configuration, action, hints, run_cache_key);
+	if (use_run_cache) {
+		TRun_Cache_Result cached_result;
+		if (Lookup_Run_Cache(run_cache_key, expected_param_size, cached_result)) {
+			if (Write_Parameters_To_Optimize(configuration, action.parameters_to_optimize, cached_result.parameters)) {
+				std::wcout << L"Restored the parameters and outputs from run cache entry " << run_cache_key.entry_path.wstring();
+				progress.best_metric = cached_result.fitness;
+				return Save_Optimized_Configuration(configuration, action, progress, nullptr, true);
+			}
+
+			std::wcerr << L"Cannot apply the cached result, will optimize." << std::endl;
 		}
+	}
 
-		std::wcout << L"\nParameters were succesfully optimized, saving...";
-		errors = refcnt::Swstr_list{};
-		rc = configuration->Save_To_File(nullptr, errors.get());
+	std::vector<const double*> hints_ptr;
+	for (size_t i = 0; i < hints.size(); i++) {
+		hints_ptr.push_back(hints[i].data());
+	}
+
+	refcnt::Swstr_list errors;
+
+	std::ofstream telemetry;
+	if (!action.telemetry_path.empty()) {
+		telemetry.open(filesystem::path{ action.telemetry_path }, std::ios::out | std::ios::trunc);
+		if (!telemetry) {
+			std::wcerr << L"Cannot open the telemetry file " << action.telemetry_path << std::endl;
+			return __LINE__;
+		}
+
+		telemetry << std::setprecision(std::numeric_limits<double>::max_digits10);
+	}
+
+	CPriority_Guard priority_guard;
+
+	HRESULT rc = Run_Solver_Stage(configuration, optimize_param_indices, optimize_param_names, action.solver_id, action.population_size, action.generation_count,
+		hints_ptr, progress, errors, telemetry, "global");
+
+	//optional local search; the configuration holds the best solution known, which is where the solver starts from - no other hints are given
+	//it may improve the solution even if the global search did not
+	if (((rc == S_OK) || (rc == S_FALSE)) && (action.polish_solver_id != Invalid_GUID) && !progress.cancelled) {
 		errors.for_each([](auto str) {
 			std::wcerr << str << std::endl;
 		});
+		errors = refcnt::Swstr_list{};
 
-		if (!Succeeded(S_OK)) {
-			std::wcerr << std::endl << L"Failed to save optimized parameters!" << std::endl;
+		const solver::TFitness global_fitness = progress.best_metric;
+		std::vector<double> global_parameters;
+		if (!Read_Parameters_To_Optimize(configuration, action.parameters_to_optimize, global_parameters)) {
+			std::wcerr << L"Cannot read the parameters found by the global search!" << std::endl;
 			return __LINE__;
 		}
+
+		std::vector<const double*> polish_hints_ptr;
+
+		std::wcout << L"\nGlobal fitness:";
+		for (size_t i = 0; i < solver::Maximum_Objectives_Count; i++) {
+			std::wcout << L' ' << i << L':' << global_fitness[i];
+		}
+		std::wcout << std::endl << L"Polishing...";
+
+		progress.current_progress = 0;
+		progress.max_progress = 0;
+		const HRESULT polish_rc = Run_Solver_Stage(configuration, optimize_param_indices, optimize_param_names, action.polish_solver_id, action.polish_population_size, action.polish_generation_count,
+			polish_hints_ptr, progress, errors, telemetry, "polish");
+
+		if ((polish_rc == S_OK) && Dominates(progress.best_metric, global_fitness)) {
+			rc = S_OK;
+		}
 		else {
-			std::wcout << L" saved." << std::endl;
+			//the solver may have written a non-dominating solution to the configuration, so that we put back the global one
+			if (!Write_Parameters_To_Optimize(configuration, action.parameters_to_optimize, global_parameters)) {
+				std::wcerr << std::endl << L"Cannot restore the parameters found by the global search!" << std::endl;
+				return __LINE__;
+			}
+			progress.best_metric = global_fitness;
+
+			if (Succeeded(polish_rc)) {
+				std::wcout << std::endl << L"Polishing did not improve the solution." << std::endl;
+			}
+			else {
+				std::wcerr << std::endl << L"Polishing failed! Error: " << Describe_Error(polish_rc) << std::endl;
+			}
+		}
+	}
+
+	errors.for_each([](auto str) {
+		std::wcerr << str << std::endl;
+	});
+
+	if (rc == S_OK) {
+		//an interrupted run, be it during the global search or the polishing, is not the result the key describes
+		const bool store_to_cache = use_run_cache && (progress.cancelled == 0);
+		if (Save_Optimized_Configuration(configuration, action, progress, store_to_cache ? &run_cache_key : nullptr, false) != 0) {
+			return __LINE__;
 		}
 	}
 	else if (rc == S_FALSE) {
@@ -55,7 +55,12 @@ enum class NOption_Index : TOption_Index {
 	population_size,
 	save_config,
 	hint,
-	parameters_hint
+	parameters_hint,
+	telemetry,
+	run_cache,
+	polish_solver_id,
+	polish_generation_count,
+	polish_population_size
 };
 
 using TOption_Type = std::remove_cv<decltype(option::Descriptor::type)>::type;
@@ -164,6 +169,51 @@ constexpr option::Descriptor actParameter_Hint = {
 	"--parameters_hint, -m=file_mask, but loads single hint from a parameters file"
 };
 
+constexpr option::Descriptor actTelemetry = {
+	static_cast<TOption_Index>(NOption_Index::telemetry),
+	static_cast<TOption_Type>(NAction_Type::unused),
+	"t",
+	"telemetry",
+	option::Arg::Optional,
+	"--telemetry, -t=file writes optimization progress as JSON lines, one record per progress change"
+};
+
+constexpr option::Descriptor actRun_Cache = {
+	static_cast<TOption_Index>(NOption_Index::run_cache),
+	static_cast<TOption_Type>(NAction_Type::unused),
+	"c",
+	"run_cache",
+	option::Arg::Optional,
+	"--run_cache, -c=directory skips an already done, identical execution or optimization with unchanged inputs and libraries - restores its outputs, and optimized parameters, from there; stores new runs there"
+};
+
+constexpr option::Descriptor actPolish_Solver_Id = {
+	static_cast<TOption_Index>(NOption_Index::polish_solver_id),
+	static_cast<TOption_Type>(NAction_Type::unused),
+	"l",
+	"polish_solver_id",
+	option::Arg::Optional,
+	"--polish_solver_id, -l={solver-guid} \t\tpolishes the result of the solver with this (local) solver"
+};
+
+constexpr option::Descriptor actPolish_Generation_Count = {
+	static_cast<TOption_Index>(NOption_Index::polish_generation_count),
+	static_cast<TOption_Type>(NAction_Type::unused),
+	"n",
+	"polish_generation_count",
+	option::Arg::Optional,
+	"--polish_generation_count, -n=sets the maximum number of generations/iterations for the polishing solver"
+};
+
+constexpr option::Descriptor actPolish_Population_Size = {
+	static_cast<TOption_Index>(NOption_Index::polish_population_size),
+	static_cast<TOption_Type>(NAction_Type::unused),
+	"y",
+	"polish_population_size",
+	option::Arg::Optional,
+	"--polish_population_size, -y=sets the population size/problem stepping for the polishing solver, if applicable"
+};
+
 constexpr option::Descriptor Zero_Terminating_Option = {
 	static_cast<TOption_Index>(NOption_Index::invalid),
 	static_cast<TOption_Type>(NAction_Type::unused),
@@ -173,7 +223,7 @@ constexpr option::Descriptor Zero_Terminating_Option = {
 	nullptr
 };
 
-constexpr std::array<option::Descriptor, 12> option_syntax{
+constexpr std::array<option::Descriptor, 17> option_syntax{
 	Unknown_Option,
 	actExecute,
 	actOptimize,
@@ -185,6 +235,11 @@ constexpr std::array<option::Descriptor, 12> option_syntax{
 	actVariable,
 	actHint,
 	actParameter_Hint,
+	actTelemetry,
+	actRun_Cache,
+	actPolish_Solver_Id,
+	actPolish_Generation_Count,
+	actPolish_Population_Size,
 	Zero_Terminating_Option
 };
 
@@ -370,6 +425,64 @@ TAction Resolve_Parameters(TAction &known_config, std::vector<option::Option>& o
 
 		//2.7 gather hints for the optimization from parameters file
 		result.hinting_parameters_to_load = Gather_Values(NOption_Index::parameters_hint, options);
+
+		//2.8 telemetry output, the last one given wins
+		const std::vector<std::wstring> telemetry_files = Gather_Values(NOption_Index::telemetry, options);
+		if (!telemetry_files.empty()) {
+			result.telemetry_path = telemetry_files.back();
+			std::wcout << L"Telemetry will be written to: " << result.telemetry_path << std::endl;
+		}
+
+		//2.9 run cache directory, the last one given wins
+		const std::vector<std::wstring> run_cache_dirs = Gather_Values(NOption_Index::run_cache, options);
+		if (!run_cache_dirs.empty()) {
+			result.run_cache_dir = run_cache_dirs.back();
+			std::wcout << L"Run cache directory set to: " << result.run_cache_dir << std::endl;
+		}
+
+		//2.10 optional polishing solver
+		const auto& polish_solver_id_arg = options[static_cast<size_t>(NOption_Index::polish_solver_id)];
+		if (polish_solver_id_arg) {
+			bool ok = false;
+			const GUID polish_solver_id = WString_To_GUID(Widen_Char(polish_solver_id_arg.arg), ok);
+			scgms::TSolver_Descriptor solver_desc = scgms::Null_Solver_Descriptor;
+			if (!ok || !scgms::get_solver_descriptor_by_id(polish_solver_id, solver_desc)) {
+				std::wcerr << L"Cannot resolve the polishing solver id to a known solver descriptor!" << std::endl;
+				result.action = NAction::failed_configuration;
+				return result;
+			}
+
+			result.polish_solver_id = polish_solver_id;
+			std::wcout << L"Resolved polishing solver id to: " << solver_desc.description << std::endl;
+
+			const auto& polish_generation_count_arg = options[static_cast<size_t>(NOption_Index::polish_generation_count)];
+			if (polish_generation_count_arg) {
+				const size_t polish_generation_count = str_2_uint(polish_generation_count_arg.arg, ok);
+				if (!ok) {
+					std::wcerr << L"Cannot resolve polishing generation count to a non-negative number!" << std::endl;
+					result.action = NAction::failed_configuration;
+					return result;
+				}
+
+				result.polish_generation_count = polish_generation_count;
+			}
+
+			std::wcout << L"Polishing generation count set to: " << result.polish_generation_count << std::endl;
+
+			const auto& polish_population_size_arg = options[static_cast<size_t>(NOption_Index::polish_population_size)];
+			if (polish_population_size_arg) {
+				const size_t polish_population_size = str_2_uint(polish_population_size_arg.arg, ok);
+				if (!ok) {
+					std::wcerr << L"Cannot resolve polishing population size to a non-negative number!" << std::endl;
+					result.action = NAction::failed_configuration;
+					return result;
+				}
+
+				result.polish_population_size = polish_population_size;
+			}
+
+			std::wcout << L"Polishing population size set to: " << result.polish_population_size << std::endl;
+		}
 	}
 
 	return result;
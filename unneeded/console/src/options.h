@@ -39,6 +39,7 @@
 
 #include <scgms/rtl/FilesystemLib.h>
 #include <scgms/iface/UIIface.h>
+#include <scgms/rtl/guid.h>
 
 #include <vector>
 
@@ -70,6 +71,12 @@ struct TAction {
 	size_t generation_count = 96;
 	size_t population_size = 1000;
 
+	// local solver run after the global one, starting from its best solution; Invalid_GUID if not used
+	GUID polish_solver_id = Invalid_GUID;
+	size_t polish_generation_count = 100;
+	// local solvers need far fewer candidates per generation than the global ones
+	size_t polish_population_size = 100;
+
 	std::vector<TOptimize_Parameter> parameters_to_optimize;
 	std::vector<TVariable> variables;
 
@@ -77,6 +84,12 @@ struct TAction {
 	std::vector<std::wstring> hints_to_load;
 	// filenames of hinting parameters to be loaded; may include wildcard
 	std::vector<std::wstring> hinting_parameters_to_load;
+
+	// JSON-lines file to write the optimization progress records to; empty if not used
+	std::wstring telemetry_path;
+
+	// directory with results and outputs of already done, bit-identical executions and optimizations; empty if not used
+	std::wstring run_cache_dir;
 };
 
 TAction Parse_Options(const int argc, const char** argv);
@@ -0,0 +1,511 @@
+/**
+ * SmartCGMS - continuous glucose monitoring and controlling framework
+ * https://diabetes.zcu.cz/
+ *
+ * Copyright (c) since 2018 University of West Bohemia.
+ *
+ * Contact:
+ * diabetes@mail.kiv.zcu.cz
+ * Medical Informatics, Department of Computer Science and Engineering
+ * Faculty of Applied Sciences, University of West Bohemia
+ * Univerzitni 8, 301 00 Pilsen
+ * Czech Republic
+ * 
+ * 
+ * Purpose of this software:
+ * This software is intended to demonstrate work of the diabetes.zcu.cz research
+ * group to other scientists, to complement our published papers. It is strictly
+ * prohibited to use this software for diagnosis or treatment of any medical condition,
+ * without obtaining all required approvals from respective regulatory bodies.
+ *
+ * Especially, a diabetic patient is warned that unauthorized use of this software
+ * may result into severe injure, including death.
+ *
+ *
+ * Licensing terms:
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under these license terms is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * a) This file is available under the Apache License, Version 2.0.
+ * b) When publishing any derivative work or results obtained using this software, you agree to cite the following paper:
+ *    Tomas Koutny and Martin Ubl, "SmartCGMS as a Testbed for a Blood-Glucose Level Prediction and/or 
+ *    Control Challenge with (an FDA-Accepted) Diabetic Patient Simulation", Procedia Computer Science,  
+ *    Volume 177, pp. 354-362, 2020
+ */
+
+#include "run_cache.h"
+
+#include <scgms/utils/string_utils.h>
+
+#include <iostream>
+#include <fstream>
+#include <array>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <limits>
+
+namespace run_cache {
+	constexpr std::array<char, 8> Magic = { 'S', 'C', 'G', 'M', 'S', 'R', 'U', 'N' };
+	constexpr uint32_t Version = 1;
+	const wchar_t* Entry_Extension = L".scgmsrun";
+#if defined(_WIN32)
+	const wchar_t* Library_Extension = L".dll";
+#elif defined(__APPLE__)
+	const wchar_t* Library_Extension = L".dylib";
+#else
+	const wchar_t* Library_Extension = L".so";
+#endif
+	// no real path is that long; a longer one means a corrupted entry, which must not make us allocate an arbitrary amount of memory
+	constexpr uint64_t Max_Path_Length = 64 * 1024;
+
+	// 64-bit FNV-1a; we need to detect identical experiments, not to resist collisions crafted on purpose
+	class CHash {
+		protected:
+			uint64_t mValue = 0xcbf29ce484222325ULL;
+		public:
+			void Add(const void* data, const size_t size) {
+				const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+				for (size_t i = 0; i < size; i++) {
+					mValue ^= bytes[i];
+					mValue *= 0x100000001b3ULL;
+				}
+			}
+
+			template <typename T>
+			void Add(const T& value) {
+				Add(&value, sizeof(value));
+			}
+
+			void Add(const std::wstring& str) {
+				Add(str.size());
+				Add(str.data(), str.size() * sizeof(wchar_t));
+			}
+
+			uint64_t Value() const {
+				return mValue;
+			}
+	};
+
+	bool Hash_File(const std::wstring& path, CHash& hash) {
+		std::ifstream file{ filesystem::path{ path }, std::ios::binary };
+		if (!file) {
+			return false;
+		}
+
+		std::array<char, 64 * 1024> buffer;
+		while (file) {
+			file.read(buffer.data(), buffer.size());
+			hash.Add(buffer.data(), static_cast<size_t>(file.gcount()));
+		}
+
+		return file.eof();
+	}
+
+	TRun_Cache_File Hash_Referenced_File(const std::wstring& path) {
+		TRun_Cache_File result;
+		result.path = path;
+
+		CHash hash;
+		result.existed = Is_Regular_File_Or_Symlink(path) && Hash_File(path, hash);
+		result.content_hash = hash.Value();
+
+		return result;
+	}
+
+	// all the files the filters refer to, including the ones, which do not exist yet, as they may be created by the run
+	std::vector<TRun_Cache_File> Hash_Referenced_Files(scgms::SPersistent_Filter_Chain_Configuration& configuration) {
+		std::vector<std::wstring> paths;
+
+		scgms::IFilter_Configuration_Link** link_begin, ** link_end;
+		if (configuration->get(&link_begin, &link_end) == S_OK) {
+			const size_t link_count = static_cast<size_t>(std::distance(link_begin, link_end));
+			for (size_t i = 0; i < link_count; i++) {
+				scgms::SFilter_Configuration_Link link = configuration[i];
+				if (!link) {
+					continue;
+				}
+
+				link.for_each([&link, &paths](scgms::SFilter_Parameter parameter) {
+					if (parameter.type() == scgms::NParameter_Type::ptWChar_Array) {
+						const std::wstring path = link.Read_File_Path(parameter.configuration_name()).wstring();
+						if (!path.empty()) {
+							paths.push_back(path);
+						}
+					}
+				});
+			}
+		}
+
+		//e.g.; the same log may be both written and read by the chain
+		std::sort(paths.begin(), paths.end());
+		paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+		std::vector<TRun_Cache_File> result;
+		for (const auto& path : paths) {
+			result.push_back(Hash_Referenced_File(path));
+		}
+
+		return result;
+	}
+
+	// values of all parameters of all filters, as the filters will read them, i.e.; with variables expanded
+	bool Hash_Resolved_Configuration(scgms::SPersistent_Filter_Chain_Configuration& configuration, CHash& hash) {
+		scgms::IFilter_Configuration_Link** link_begin, ** link_end;
+		if (configuration->get(&link_begin, &link_end) != S_OK) {
+			return false;
+		}
+
+		const size_t link_count = static_cast<size_t>(std::distance(link_begin, link_end));
+		hash.Add(link_count);
+		for (size_t i = 0; i < link_count; i++) {
+			scgms::SFilter_Configuration_Link link = configuration[i];
+			if (!link) {
+				return false;
+			}
+
+			hash.Add(link.descriptor().id);
+			link.for_each([&hash](scgms::SFilter_Parameter parameter) {
+				HRESULT rc = E_FAIL;
+				const std::wstring value = parameter.as_wstring(rc, true);
+
+				hash.Add(std::wstring{ parameter.configuration_name() });
+				hash.Add(rc);
+				hash.Add(Succeeded(rc) ? value : std::wstring{});
+			});
+		}
+
+		return true;
+	}
+
+	// the filter and solver libraries, so that a rebuilt library invalidates the entries computed with its former version
+	void Hash_Libraries(CHash& hash) {
+		const filesystem::path application_dir = Get_Application_Dir();
+		//the scgms library resides next to the application, while the filters and solvers are loaded from its filters subdirectory
+		const std::array<filesystem::path, 2> library_dirs = { application_dir, application_dir / L"filters" };
+
+		std::vector<filesystem::path> libraries;
+		for (const auto& dir : library_dirs) {
+			std::error_code ec;
+			for (const auto& entry : filesystem::directory_iterator{ dir, ec }) {
+				if (entry.is_regular_file(ec) && (entry.path().extension().wstring() == Library_Extension)) {
+					libraries.push_back(entry.path());
+				}
+			}
+		}
+
+		//the enumeration order is not specified
+		std::sort(libraries.begin(), libraries.end());
+
+		hash.Add(libraries.size());
+		for (const auto& library : libraries) {
+			CHash library_hash;
+			if (!Hash_File(library.wstring(), library_hash)) {
+				library_hash.Add(std::numeric_limits<uint64_t>::max());	//unreadable library still makes a difference
+			}
+
+			hash.Add(library.filename().wstring());
+			hash.Add(library_hash.Value());
+		}
+	}
+
+	template <typename T>
+	void Write_Value(std::ofstream& file, const T& value) {
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	template <typename T>
+	bool Read_Value(std::ifstream& file, T& value) {
+		file.read(reinterpret_cast<char*>(&value), sizeof(value));
+		return static_cast<bool>(file);
+	}
+
+	void Write_Path(std::ofstream& file, const std::wstring& path) {
+		const std::string narrow_path = Narrow_WString(path);
+		Write_Value(file, static_cast<uint64_t>(narrow_path.size()));
+		file.write(narrow_path.data(), narrow_path.size());
+	}
+
+	bool Read_Path(std::ifstream& file, std::wstring& path) {
+		uint64_t path_length = 0;
+		if (!Read_Value(file, path_length) || (path_length > Max_Path_Length)) {
+			return false;
+		}
+
+		std::string narrow_path(static_cast<size_t>(path_length), '\0');
+		file.read(narrow_path.data(), narrow_path.size());
+		if (!file) {
+			return false;
+		}
+
+		path = Widen_String(narrow_path);
+		return true;
+	}
+
+	bool Copy_File_Contents(const std::wstring& path, std::ofstream& entry) {
+		std::error_code ec;
+		const uint64_t size = static_cast<uint64_t>(filesystem::file_size(filesystem::path{ path }, ec));
+		std::ifstream file{ filesystem::path{ path }, std::ios::binary };
+		if (ec || !file) {
+			return false;
+		}
+
+		Write_Value(entry, size);
+
+		std::array<char, 64 * 1024> buffer;
+		uint64_t remaining = size;
+		while (remaining > 0) {
+			const size_t chunk = static_cast<size_t>(std::min<uint64_t>(remaining, buffer.size()));
+			if (!file.read(buffer.data(), chunk)) {
+				return false;	//the file has shrunk meanwhile
+			}
+
+			entry.write(buffer.data(), chunk);
+			remaining -= chunk;
+		}
+
+		return static_cast<bool>(entry);
+	}
+
+	bool Restore_File(const std::wstring& path, const std::string& contents) {
+		std::error_code ec;
+		const filesystem::path target_path{ path };
+		if (target_path.has_parent_path()) {
+			filesystem::create_directories(target_path.parent_path(), ec);
+		}
+
+		std::ofstream file{ target_path, std::ios::binary | std::ios::trunc };
+		file.write(contents.data(), contents.size());
+		return static_cast<bool>(file);
+	}
+}
+
+bool Prepare_Run_Cache_Key(const std::wstring& cache_dir, scgms::SPersistent_Filter_Chain_Configuration& configuration, const TAction& action, const std::vector<std::vector<double>>& hints, TRun_Cache_Key& key) {
+
+	run_cache::CHash hash;
+	hash.Add(run_cache::Version);
+	hash.Add(action.action);
+
+	//configuration as the filters will see it; it already includes the variables given on the command line and by the operating system
+	if (!run_cache::Hash_Resolved_Configuration(configuration, hash)) {
+		std::wcerr << L"Cannot read the configuration to compute the run cache key!" << std::endl;
+		return false;
+	}
+
+	run_cache::Hash_Libraries(hash);
+
+	if (action.action == NAction::optimize) {
+		//solver settings
+		hash.Add(action.solver_id);
+		hash.Add(action.generation_count);
+		hash.Add(action.population_size);
+		if (action.polish_solver_id != Invalid_GUID) {
+			hash.Add(action.polish_solver_id);
+			hash.Add(action.polish_generation_count);
+			hash.Add(action.polish_population_size);
+		}
+
+		hash.Add(action.parameters_to_optimize.size());
+		for (const auto& param : action.parameters_to_optimize) {
+			hash.Add(param.index);
+			hash.Add(param.name);
+		}
+
+		hash.Add(hints.size());
+		for (const auto& hint : hints) {
+			hash.Add(hint.size());
+			hash.Add(hint.data(), hint.size() * sizeof(double));
+		}
+	}
+	else {
+		hash.Add(action.save_config);
+	}
+
+	std::wostringstream entry_name;
+	entry_name << std::hex << std::setw(16) << std::setfill(L'0') << hash.Value() << run_cache::Entry_Extension;
+
+	key.entry_path = filesystem::path{ cache_dir } / entry_name.str();
+	key.referenced_files = run_cache::Hash_Referenced_Files(configuration);
+
+	//the optimization saves the configuration after the entry is stored, from the cached parameters; the execution saves it on its own
+	if ((action.action == NAction::execute) && action.save_config) {
+		key.referenced_files.push_back(run_cache::Hash_Referenced_File(filesystem::absolute(filesystem::path{ action.config_path }).wstring()));
+	}
+
+	return true;
+}
+
+bool Lookup_Run_Cache(const TRun_Cache_Key& key, const size_t expected_parameters_size, TRun_Cache_Result& result) {
+
+	if (!Is_Regular_File_Or_Symlink(key.entry_path.wstring())) {
+		return false;
+	}
+
+	std::error_code ec;
+	const uint64_t entry_size = static_cast<uint64_t>(filesystem::file_size(key.entry_path, ec));
+	std::ifstream entry{ key.entry_path, std::ios::binary };
+	if (ec || !entry) {
+		return false;
+	}
+
+	auto remaining_size = [&entry, entry_size]() -> uint64_t {
+		const auto position = entry.tellg();
+		return (position < 0) || (static_cast<uint64_t>(position) > entry_size) ? 0 : entry_size - static_cast<uint64_t>(position);
+	};
+
+	auto corrupted = [&key]() {
+		std::wcerr << L"Ignoring corrupted run cache entry " << key.entry_path.wstring() << std::endl;
+		return false;
+	};
+
+	std::array<char, 8> magic;
+	uint32_t version = 0, objectives_count = 0;
+	if (!run_cache::Read_Value(entry, magic) || !run_cache::Read_Value(entry, version) || !run_cache::Read_Value(entry, objectives_count)
+		|| (magic != run_cache::Magic) || (version != run_cache::Version) || (objectives_count != solver::Maximum_Objectives_Count)) {
+		return corrupted();
+	}
+
+	//all the inputs the entry was computed from must still have the same contents
+	uint64_t inputs_count = 0;
+	if (!run_cache::Read_Value(entry, inputs_count)) {
+		return corrupted();
+	}
+
+	for (uint64_t i = 0; i < inputs_count; i++) {
+		std::wstring path;
+		uint64_t content_hash = 0;
+		if (!run_cache::Read_Path(entry, path) || !run_cache::Read_Value(entry, content_hash)) {
+			return corrupted();
+		}
+
+		const auto current = std::find_if(key.referenced_files.begin(), key.referenced_files.end(), [&path](const TRun_Cache_File& file) {
+			return file.path == path;
+		});
+
+		if ((current == key.referenced_files.end()) || !current->existed || (current->content_hash != content_hash)) {
+			std::wcout << L"Run cache entry is stale, input " << path << L" has changed." << std::endl;
+			return false;
+		}
+	}
+
+	//outputs are restored only once the whole entry has been read successfully
+	uint64_t outputs_count = 0;
+	if (!run_cache::Read_Value(entry, outputs_count)) {
+		return corrupted();
+	}
+
+	std::vector<std::pair<std::wstring, std::string>> outputs;
+	for (uint64_t i = 0; i < outputs_count; i++) {
+		std::wstring path;
+		uint64_t contents_size = 0;
+		if (!run_cache::Read_Path(entry, path) || !run_cache::Read_Value(entry, contents_size) || (contents_size > remaining_size())) {
+			return corrupted();
+		}
+
+		std::string contents(static_cast<size_t>(contents_size), '\0');
+		entry.read(contents.data(), contents.size());
+		if (!entry) {
+			return corrupted();
+		}
+
+		outputs.push_back({ std::move(path), std::move(contents) });
+	}
+
+	uint64_t parameters_count = 0;
+	if (!run_cache::Read_Value(entry, parameters_count) || (parameters_count != static_cast<uint64_t>(expected_parameters_size))) {
+		return corrupted();
+	}
+
+	for (size_t i = 0; i < solver::Maximum_Objectives_Count; i++) {
+		run_cache::Read_Value(entry, result.fitness[i]);
+	}
+
+	result.parameters.resize(expected_parameters_size);
+	entry.read(reinterpret_cast<char*>(result.parameters.data()), result.parameters.size() * sizeof(double));
+	if (!entry) {
+		return corrupted();
+	}
+
+	for (const auto& output : outputs) {
+		if (!run_cache::Restore_File(output.first, output.second)) {
+			std::wcerr << L"Cannot restore the output " << output.first << L" from the run cache!" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Store_Run_Cache(const TRun_Cache_Key& key, const TRun_Cache_Result& result) {
+
+	std::error_code ec;
+	filesystem::create_directories(key.entry_path.parent_path(), ec);
+	if (ec) {
+		std::wcerr << L"Cannot create the run cache directory " << key.entry_path.parent_path().wstring() << std::endl;
+		return false;
+	}
+
+	//unchanged files are inputs the result depends on; files created or rewritten by the run are its outputs
+	std::vector<TRun_Cache_File> inputs;
+	std::vector<std::wstring> outputs;
+	for (const auto& file : key.referenced_files) {
+		const TRun_Cache_File current = run_cache::Hash_Referenced_File(file.path);
+		if (!current.existed) {
+			continue;
+		}
+
+		if (file.existed && (current.content_hash == file.content_hash)) {
+			inputs.push_back(file);
+		}
+		else {
+			outputs.push_back(file.path);
+		}
+	}
+
+	filesystem::path temporary_path{ key.entry_path };
+	temporary_path += L".tmp";
+
+	{
+		std::ofstream entry{ temporary_path, std::ios::binary | std::ios::trunc };
+		if (!entry) {
+			std::wcerr << L"Cannot open the run cache entry " << temporary_path.wstring() << L" for writing!" << std::endl;
+			return false;
+		}
+
+		run_cache::Write_Value(entry, run_cache::Magic);
+		run_cache::Write_Value(entry, run_cache::Version);
+		run_cache::Write_Value(entry, static_cast<uint32_t>(solver::Maximum_Objectives_Count));
+
+		run_cache::Write_Value(entry, static_cast<uint64_t>(inputs.size()));
+		for (const auto& input : inputs) {
+			run_cache::Write_Path(entry, input.path);
+			run_cache::Write_Value(entry, input.content_hash);
+		}
+
+		run_cache::Write_Value(entry, static_cast<uint64_t>(outputs.size()));
+		for (const auto& output : outputs) {
+			run_cache::Write_Path(entry, output);
+			if (!run_cache::Copy_File_Contents(output, entry)) {
+				std::wcerr << L"Cannot store the output " << output << L" to the run cache!" << std::endl;
+				entry.close();
+				filesystem::remove(temporary_path, ec);
+				return false;
+			}
+		}
+
+		run_cache::Write_Value(entry, static_cast<uint64_t>(result.parameters.size()));
+		for (size_t i = 0; i < solver::Maximum_Objectives_Count; i++) {
+			run_cache::Write_Value(entry, result.fitness[i]);
+		}
+		entry.write(reinterpret_cast<const char*>(result.parameters.data()), result.parameters.size() * sizeof(double));
+
+		if (!entry) {
+			std::wcerr << L"Failed to write the run cache entry " << temporary_path.wstring() << std::endl;
+			return false;
+		}
+	}
+
+	filesystem::rename(temporary_path, key.entry_path, ec);
+	return !ec;
+}
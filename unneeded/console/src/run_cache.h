@@ -0,0 +1,81 @@
+/**
+ * SmartCGMS - continuous glucose monitoring and controlling framework
+ * https://diabetes.zcu.cz/
+ *
+ * Copyright (c) since 2018 University of West Bohemia.
+ *
+ * Contact:
+ * diabetes@mail.kiv.zcu.cz
+ * Medical Informatics, Department of Computer Science and Engineering
+ * Faculty of Applied Sciences, University of West Bohemia
+ * Univerzitni 8, 301 00 Pilsen
+ * Czech Republic
+ * 
+ * 
+ * Purpose of this software:
+ * This software is intended to demonstrate work of the diabetes.zcu.cz research
+ * group to other scientists, to complement our published papers. It is strictly
+ * prohibited to use this software for diagnosis or treatment of any medical condition,
+ * without obtaining all required approvals from respective regulatory bodies.
+ *
+ * Especially, a diabetic patient is warned that unauthorized use of this software
+ * may result into severe injure, including death.
+ *
+ *
+ * Licensing terms:
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under these license terms is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * a) This file is available under the Apache License, Version 2.0.
+ * b) When publishing any derivative work or results obtained using this software, you agree to cite the following paper:
+ *    Tomas Koutny and Martin Ubl, "SmartCGMS as a Testbed for a Blood-Glucose Level Prediction and/or 
+ *    Control Challenge with (an FDA-Accepted) Diabetic Patient Simulation", Procedia Computer Science,  
+ *    Volume 177, pp. 354-362, 2020
+ */
+
+#pragma once
+
+#include "options.h"
+
+#include <scgms/rtl/FilterLib.h>
+#include <scgms/rtl/SolverLib.h>
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/*
+ * Opt-in cache of experiment runs, so that a bit-identical run does not have to be executed, or optimized, again.
+ * The entry is addressed by a hash of the action, the resolved configuration (i.e.; with variables expanded), the filter and solver libraries
+ * and, for the optimization, the solver settings, the parameters to optimize and the hints.
+ * The files referenced by the filters are sorted out after the run - those, which did not change, are inputs and the entry records hashes
+ * of their contents, so that it is invalidated once any of the inputs changes; those, which the run created or rewrote, are outputs
+ * (e.g.; logs, or the configuration saved after the execution) and the entry stores their contents to restore them on a cache hit.
+ * For the optimization, the entry also holds the optimized parameters and their fitness.
+ */
+
+struct TRun_Cache_File {
+	std::wstring path;
+	bool existed = false;
+	uint64_t content_hash = 0;	// valid only if the file existed
+};
+
+struct TRun_Cache_Key {
+	filesystem::path entry_path;
+	// files referenced by the configuration, as they were before the run
+	std::vector<TRun_Cache_File> referenced_files;
+};
+
+struct TRun_Cache_Result {
+	// optimized parameters, empty for the execution
+	std::vector<double> parameters;
+	solver::TFitness fitness = solver::Nan_Fitness;
+};
+
+// computes the key of the run to be done; returns false if the key cannot be computed, i.e.; the cache cannot be used
+bool Prepare_Run_Cache_Key(const std::wstring& cache_dir, scgms::SPersistent_Filter_Chain_Configuration& configuration, const TAction& action, const std::vector<std::vector<double>>& hints, TRun_Cache_Key& key);
+// returns true, if there is a valid entry for the key; then, it has already restored the output files and returns the cached result
+bool Lookup_Run_Cache(const TRun_Cache_Key& key, const size_t expected_parameters_size, TRun_Cache_Result& result);
+// stores the result and the output files of a completed run; the referenced files are re-hashed to tell the inputs from the outputs
+bool Store_Run_Cache(const TRun_Cache_Key& key, const TRun_Cache_Result& result);
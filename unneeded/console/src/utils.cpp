@@ -37,6 +37,11 @@
 #include "utils.h"
 
 #include <fstream>
+#include <set>
+#include <cstring>
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
 
 #include <scgms/utils/string_utils.h>
 
@@ -139,6 +144,28 @@ bool Load_Hints(const std::vector<std::wstring>& hint_paths, const size_t expect
 	return true;
 }
 
+size_t Remove_Duplicate_Hints(std::vector<std::vector<double>>& hints_container) {
+	//compare bit patterns, so that NaNs and bit-identical vectors are treated alike and the solver does not evaluate them twice
+	std::set<std::vector<uint64_t>> known_hints;
+
+	const auto bit_pattern = [](const std::vector<double>& hint) {
+		std::vector<uint64_t> result(hint.size());
+		if (!hint.empty()) {
+			std::memcpy(result.data(), hint.data(), hint.size() * sizeof(double));
+		}
+		return result;
+	};
+
+	const auto new_end = std::remove_if(hints_container.begin(), hints_container.end(), [&](const std::vector<double>& hint) {
+		return !known_hints.insert(bit_pattern(hint)).second;
+	});
+
+	const size_t removed_count = static_cast<size_t>(std::distance(new_end, hints_container.end()));
+	hints_container.erase(new_end, hints_container.end());
+
+	return removed_count;
+}
+
 std::tuple<HRESULT, scgms::SPersistent_Filter_Chain_Configuration> Load_Experimental_Setup(int argc, char** argv, const std::vector<TVariable> &variables) {
 	std::tuple<HRESULT, scgms::SPersistent_Filter_Chain_Configuration> result;
 
@@ -210,3 +237,67 @@ std::tuple<HRESULT, size_t> Count_Parameters_Size(scgms::SPersistent_Filter_Chai
 
 	return { S_OK, count };
 }
+
+bool Read_Parameters_To_Optimize(scgms::SPersistent_Filter_Chain_Configuration& configuration, const std::vector<TOptimize_Parameter>& parameters, std::vector<double>& values) {
+
+	values.clear();
+
+	for (size_t i = 0; i < parameters.size(); i++) {
+
+		scgms::SFilter_Configuration_Link configuration_link_parameters = configuration[parameters[i].index];
+		if (!configuration_link_parameters) {
+			return false;
+		}
+
+		std::vector<double> lbound, params, ubound;
+		if (!configuration_link_parameters.Read_Parameters(parameters[i].name.c_str(), lbound, params, ubound)) {
+			return false;
+		}
+
+		values.insert(values.end(), params.begin(), params.end());
+	}
+
+	return true;
+}
+
+bool Write_Parameters_To_Optimize(scgms::SPersistent_Filter_Chain_Configuration& configuration, const std::vector<TOptimize_Parameter>& parameters, const std::vector<double>& values) {
+
+	size_t values_offset = 0;
+
+	for (size_t i = 0; i < parameters.size(); i++) {
+
+		scgms::SFilter_Configuration_Link configuration_link_parameters = configuration[parameters[i].index];
+		if (!configuration_link_parameters) {
+			return false;
+		}
+
+		bool written = false;
+		configuration_link_parameters.for_each([&](scgms::SFilter_Parameter parameter) {
+			if (written || (std::wstring_view{ parameter.configuration_name() } != parameters[i].name)) {
+				return;
+			}
+
+			//the array holds lower bounds, parameters and upper bounds, in this order
+			HRESULT rc = E_FAIL;
+			std::vector<double> bounded_params = parameter.as_double_array(rc);
+			if (!Succeeded(rc) || (bounded_params.size() % 3 != 0)) {
+				return;
+			}
+
+			const size_t params_count = bounded_params.size() / 3;
+			if (values_offset + params_count > values.size()) {
+				return;
+			}
+
+			std::copy(values.begin() + values_offset, values.begin() + values_offset + params_count, bounded_params.begin() + params_count);
+			written = Succeeded(parameter.set_double_array(bounded_params));
+			values_offset += params_count;
+		});
+
+		if (!written) {
+			return false;
+		}
+	}
+
+	return values_offset == values.size();
+}
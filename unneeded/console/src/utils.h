@@ -62,5 +62,10 @@
 
 std::tuple<HRESULT, scgms::SPersistent_Filter_Chain_Configuration> Load_Experimental_Setup(int argc, char** argv, const std::vector<TVariable> &variables);
 bool Load_Hints(const std::vector<std::wstring>& hint_paths, const size_t parameters_file_type, const bool parameters_file, std::vector<std::vector<double>>& hints_container); //paths may include wildcard
+size_t Remove_Duplicate_Hints(std::vector<std::vector<double>>& hints_container);	//returns the number of removed hints
 
 std::tuple<HRESULT, size_t> Count_Parameters_Size(scgms::SPersistent_Filter_Chain_Configuration& configuration, const std::vector<TOptimize_Parameter>& parameters);
+//concatenates current values of the given parameters, i.e.; the layout used by hints
+bool Read_Parameters_To_Optimize(scgms::SPersistent_Filter_Chain_Configuration& configuration, const std::vector<TOptimize_Parameter>& parameters, std::vector<double>& values);
+//inverse to Read_Parameters_To_Optimize; bounds of the parameters are kept
+bool Write_Parameters_To_Optimize(scgms::SPersistent_Filter_Chain_Configuration& configuration, const std::vector<TOptimize_Parameter>& parameters, const std::vector<double>& values);
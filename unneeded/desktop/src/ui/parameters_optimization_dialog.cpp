@@ -139,6 +139,74 @@ void CParameters_Optimization_Dialog::Populate_Parameters_Info(scgms::SFilter_Ch
 	});
 }
 
+// true, if the candidate is nowhere worse than the reference and better in at least one objective; NaN is worse than any number
+static bool Dominates(const solver::TFitness& candidate, const solver::TFitness& reference) {
+	bool better_somewhere = false;
+	for (size_t i = 0; i < solver::Maximum_Objectives_Count; i++) {
+		const bool candidate_nan = std::isnan(candidate[i]);
+		const bool reference_nan = std::isnan(reference[i]);
+		if (candidate_nan && reference_nan) {
+			continue;
+		}
+
+		if (candidate_nan || (!reference_nan && (candidate[i] > reference[i]))) {
+			return false;
+		}
+
+		if (reference_nan || (candidate[i] < reference[i])) {
+			better_somewhere = true;
+		}
+	}
+
+	return better_somewhere;
+}
+
+std::vector<std::vector<double>> CParameters_Optimization_Dialog::Read_Solved_Parameters() {
+	std::vector<std::vector<double>> result(mSolve_filter_info_indices.size());
+
+	size_t filter_index = 0;
+	mConfiguration.for_each([this, &filter_index, &result](scgms::SFilter_Configuration_Link link) {
+		for (size_t i = 0; i < mSolve_filter_info_indices.size(); i++) {
+			if (mSolve_filter_info_indices[i] != filter_index) {
+				continue;
+			}
+
+			link.for_each([this, i, &result](scgms::SFilter_Parameter parameter) {
+				if (std::wstring_view{ parameter.configuration_name() } == mSolve_filter_parameter_names[i]) {
+					HRESULT rc = E_FAIL;
+					std::vector<double> values = parameter.as_double_array(rc);
+					if (Succeeded(rc)) {
+						result[i] = std::move(values);
+					}
+				}
+			});
+		}
+
+		filter_index++;
+	});
+
+	return result;
+}
+
+void CParameters_Optimization_Dialog::Write_Solved_Parameters(const std::vector<std::vector<double>>& parameters) {
+	size_t filter_index = 0;
+	mConfiguration.for_each([this, &filter_index, &parameters](scgms::SFilter_Configuration_Link link) {
+		for (size_t i = 0; i < mSolve_filter_info_indices.size(); i++) {
+			if ((mSolve_filter_info_indices[i] != filter_index) || parameters[i].empty()) {
+				continue;
+			}
+
+			link.for_each([this, i, &parameters](scgms::SFilter_Parameter parameter) {
+				if (std::wstring_view{ parameter.configuration_name() } == mSolve_filter_parameter_names[i]) {
+					parameter.set_double_array(parameters[i]);
+				}
+			});
+		}
+
+		filter_index++;
+	});
+}
+
 void CParameters_Optimization_Dialog::Setup_UI() {
 	setWindowTitle(dsOptimize_Parameters);
 
@@ -189,6 +257,23 @@ void CParameters_Optimization_Dialog::Setup_UI() {
 		edtPopulation_Size = new QLineEdit{ edits };
 		edtPopulation_Size->setValidator(new QIntValidator(edits));
 		edtPopulation_Size->setText("100");
+
+		cmbPolish_Solver = new QComboBox{ edits };
+		{
+			for (const auto& item : scgms::get_solver_descriptor_list()) {
+				cmbPolish_Solver->addItem(QString::fromStdWString(item.description), QVariant(GUID_To_QUuid(item.id)));
+			}
+			cmbPolish_Solver->model()->sort(0, Qt::AscendingOrder);
+			cmbPolish_Solver->insertItem(0, tr("None"), QVariant(GUID_To_QUuid(Invalid_GUID)));
+			cmbPolish_Solver->setCurrentIndex(0);
+		}
+
+		edtPolish_Generations = new QLineEdit{ edits };
+		edtPolish_Generations->setValidator(new QIntValidator(edits));
+		edtPolish_Generations->setText("100");
+		edtPolish_Population_Size = new QLineEdit{ edits };
+		edtPolish_Population_Size->setValidator(new QIntValidator(edits));
+		edtPolish_Population_Size->setText("100");
 	
 		{
 			QGridLayout *edits_layout = new QGridLayout();
@@ -200,6 +285,9 @@ void CParameters_Optimization_Dialog::Setup_UI() {
 			edits_layout->addWidget(new QLabel{ tr(selected_solver.c_str()), edits }, 1, 0);	edits_layout->addWidget(cmbSolver, 1, 1);
 			edits_layout->addWidget(new QLabel{ dsMax_Generations, edits }, 2, 0);				edits_layout->addWidget(edtMax_Generations, 2, 1);
 			edits_layout->addWidget(new QLabel{ dsPopulation_Size, edits }, 3, 0);				edits_layout->addWidget(edtPopulation_Size, 3, 1);
+			edits_layout->addWidget(new QLabel{ tr("Polishing solver"), edits }, 4, 0);			edits_layout->addWidget(cmbPolish_Solver, 4, 1);
+			edits_layout->addWidget(new QLabel{ tr("Polishing generations"), edits }, 5, 0);	edits_layout->addWidget(edtPolish_Generations, 5, 1);
+			edits_layout->addWidget(new QLabel{ tr("Polishing population size"), edits }, 6, 0);	edits_layout->addWidget(edtPolish_Population_Size, 6, 1);
 		}
 
 		QWidget* progress = new QWidget();
@@ -334,6 +422,9 @@ void CParameters_Optimization_Dialog::On_Solve() {
 			mChosen_Solver_Id = QUuid_To_GUID(solver_variant.toUuid());
 		}
 
+		const QVariant polish_solver_variant = cmbPolish_Solver->currentData();
+		mChosen_Polish_Solver_Id = polish_solver_variant.isNull() ? Invalid_GUID : QUuid_To_GUID(polish_solver_variant.toUuid());
+
 		mSolve_filter_info_indices.clear();
 		mSolve_filter_parameter_names.clear();
 
@@ -358,15 +449,19 @@ void CParameters_Optimization_Dialog::On_Solve() {
 
 			const int popSize = edtPopulation_Size->text().toInt();
 			const int maxGens = edtMax_Generations->text().toInt();
+			const int polishGens = edtPolish_Generations->text().toInt();
+			const int polishPopSize = edtPolish_Population_Size->text().toInt();
 
 			lastMetric = solver::Nan_Fitness;
 			lastProgress = 0;
+			mSolver_Stage = 0;
+			mShown_Solver_Stage = 0;
 			startDateTime = QDateTime::currentDateTime();
 			timestampLabelStart->setText(startDateTime.toLocalTime().toString());
 
 			mProgress = solver::Null_Solver_Progress;
 			mSolver_Thread = std::make_unique<std::thread>(
-				[this, popSize, maxGens]() {
+				[this, popSize, maxGens, polishGens, polishPopSize]() {
 					refcnt::Swstr_list error_description;
 					HRESULT res = scgms::Optimize_Parameters(mConfiguration, mSolve_filter_info_indices.data(), const_cast<const wchar_t**>(mSolve_filter_parameter_names.data()), mSolve_filter_info_indices.size(),
 						Setup_Filter_DB_Access, nullptr,
@@ -377,6 +472,33 @@ void CParameters_Optimization_Dialog::On_Solve() {
 						mProgress,
 						error_description);
 
+					// the configuration holds the best solution known, so that the polishing solver starts from it; it may improve the solution even if the global search did not
+					if (((res == S_OK) || (res == S_FALSE)) && (mChosen_Polish_Solver_Id != Invalid_GUID) && (mProgress.cancelled == FALSE)) {
+						const solver::TFitness global_fitness = mProgress.best_metric;
+						const std::vector<std::vector<double>> global_parameters = Read_Solved_Parameters();
+						mProgress.current_progress = 0;
+						mProgress.max_progress = 0;
+						mSolver_Stage++;
+
+						const HRESULT polish_res = scgms::Optimize_Parameters(mConfiguration, mSolve_filter_info_indices.data(), const_cast<const wchar_t**>(mSolve_filter_parameter_names.data()), mSolve_filter_info_indices.size(),
+							Setup_Filter_DB_Access, nullptr,
+							mChosen_Polish_Solver_Id,
+							polishPopSize,
+							polishGens,
+							nullptr, 0,	//additional hints; the solver starts from the current configuration, i.e.; the global best
+							mProgress,
+							error_description);
+
+						// only a dominating solution replaces the global one; otherwise, the global one is put back, as the solver may have written another one
+						if ((polish_res == S_OK) && Dominates(mProgress.best_metric, global_fitness)) {
+							res = S_OK;
+						}
+						else {
+							Write_Solved_Parameters(global_parameters);
+							mProgress.best_metric = global_fitness;
+						}
+					}
+
 					mIs_Solving = false;
 					mProgress.cancelled = TRUE;	//stops mProgress_Update_Thread
 
@@ -402,6 +524,14 @@ void CParameters_Optimization_Dialog::On_Solve() {
 
 void CParameters_Optimization_Dialog::On_Update_Progress() {
 	if (mIs_Solving) {
+		// the polishing stage restarts the progress, so that the ETA has to be computed from its own start
+		const size_t solver_stage = mSolver_Stage;
+		if (mShown_Solver_Stage != solver_stage) {
+			mShown_Solver_Stage = solver_stage;
+			startDateTime = QDateTime::currentDateTime();
+			lastProgress = 0;
+		}
+
 		if (mProgress.max_progress > 0) {
 
 			int progressValue = static_cast<int>(std::round(100.0 * mProgress.current_progress / mProgress.max_progress));
@@ -38,6 +38,7 @@
 
 #include <scgms/iface/SolverIface.h>
 #include <scgms/rtl/FilterLib.h>
+#include <scgms/rtl/guid.h>
 
 #include <QtWidgets/QDialog>
 #include <QtWidgets/QLineEdit>
@@ -51,6 +52,7 @@
 
 #include <vector>
 #include <thread>
+#include <atomic>
 
 class CParameters_Optimization_Dialog : public QDialog {
 	Q_OBJECT
@@ -68,27 +70,34 @@ class CParameters_Optimization_Dialog : public QDialog {
 		QListView* cmbParameters = nullptr;
 		QTableWidget* lstMetricHistory = nullptr;
 		QComboBox* cmbSolver = nullptr;
-		QLineEdit *edtMax_Generations, *edtPopulation_Size;
+		QComboBox* cmbPolish_Solver = nullptr;
+		QLineEdit *edtMax_Generations, *edtPopulation_Size, *edtPolish_Generations, *edtPolish_Population_Size;
 		QLabel *lblSolver_Info;
 		QProgressBar *barProgress;
 		QLabel* progressLabel1, *progressLabel2;
 		QPushButton *btnSolve, *btnStop, *btnClose;
 		QLabel* timestampLabelStart, *timestampLabelEnd;
-		QDateTime startDateTime;
+		QDateTime startDateTime;	// start of the current stage, as the progress restarts with each stage
 		solver::TFitness lastMetric = solver::Nan_Fitness;
 		size_t lastProgress = 0;
 
 		std::vector<size_t> mSolve_filter_info_indices;
 		std::vector<const wchar_t*> mSolve_filter_parameter_names;
 		GUID mChosen_Solver_Id;
+		GUID mChosen_Polish_Solver_Id = Invalid_GUID;	// local solver seeded with the result of the chosen one; Invalid_GUID if not used
 	
 		std::unique_ptr<std::thread> mSolver_Thread, mProgress_Update_Thread;
 		solver::TSolver_Progress mProgress;
+		std::atomic<size_t> mSolver_Stage{ 0 };	// incremented by the solver thread, when the polishing stage starts
+		size_t mShown_Solver_Stage = 0;
 		bool mIs_Solving = false;
 
 	protected:
 		void Setup_UI();
 		void Populate_Parameters_Info(scgms::SFilter_Chain_Configuration configuration);
+		// whole arrays of the parameters being solved, i.e.; including the bounds, in the order of mSolve_filter_info_indices
+		std::vector<std::vector<double>> Read_Solved_Parameters();
+		void Write_Solved_Parameters(const std::vector<std::vector<double>>& parameters);
 
 		void Stop_Threads();
 		void Stop_Async();
@@ -41,6 +41,7 @@
 #include <scgms/rtl/rattime.h>
 
 #include <iostream>
+#include <chrono>
 
 // default solver: Halton MetaDE
 constexpr const GUID Default_Solver_Guid = { 0x1b21b62f, 0x7c6c, 0x4027,{ 0x89, 0xbc, 0x68, 0x7d, 0x8b, 0xd3, 0x2b, 0x3c } };	// {1B21B62F-7C6C-4027-89BC-687D8BD32B3C}
@@ -64,7 +65,7 @@ void CGame_Optimizer_Wrapper::Optimizer_Thread_Fnc()
 	scgms::SPersistent_Filter_Chain_Configuration configuration;
 	refcnt::Swstr_list errors;
 
-	mOpt_State = NGame_Optimize_State::Running;
+	Set_State(NGame_Optimize_State::Running);
 
 	HRESULT rc = E_FAIL;
 	if (configuration)
@@ -72,7 +73,7 @@ void CGame_Optimizer_Wrapper::Optimizer_Thread_Fnc()
 
 	if (!Succeeded(rc))
 	{
-		mOpt_State = NGame_Optimize_State::Failed;
+		Set_State(NGame_Optimize_State::Failed);
 		return;
 	}
 
@@ -121,11 +122,21 @@ void CGame_Optimizer_Wrapper::Optimizer_Thread_Fnc()
 
 	if (!Succeeded(rc))
 	{
-		mOpt_State = NGame_Optimize_State::Failed;
+		Set_State(NGame_Optimize_State::Failed);
 		return;
 	}
 
-	mOpt_State = NGame_Optimize_State::Success;
+	Set_State(NGame_Optimize_State::Success);
+}
+
+void CGame_Optimizer_Wrapper::Set_State(NGame_Optimize_State state)
+{
+	{
+		std::unique_lock<std::mutex> lck(mOpt_State_Mtx);
+		mOpt_State = state;
+	}
+
+	mOpt_State_Cv.notify_all();
 }
 
 bool CGame_Optimizer_Wrapper::Load_Configuration(uint16_t config_class, uint16_t config_id, const std::string& log_file_input_path, const std::string& log_file_output_path)
@@ -158,7 +169,7 @@ bool CGame_Optimizer_Wrapper::Start()
 	if (mOpt_Thread)
 		return false;
 
-	mOpt_State = NGame_Optimize_State::Running;
+	Set_State(NGame_Optimize_State::Running);
 
 	mProgress.cancelled = FALSE;
 	mProgress.max_progress = 100;
@@ -191,7 +202,7 @@ bool CGame_Optimizer_Wrapper::Replay()
 
 	if (!Succeeded(rc))
 	{
-		mOpt_State = NGame_Optimize_State::Failed;
+		Set_State(NGame_Optimize_State::Failed);
 		return false;
 	}
 
@@ -243,6 +254,23 @@ bool CGame_Optimizer_Wrapper::Request_Cancel()
 	return true;
 }
 
+bool CGame_Optimizer_Wrapper::Wait(uint32_t timeout_ms)
+{
+	std::unique_lock<std::mutex> lck(mOpt_State_Mtx);
+
+	auto is_not_running = [this]() {
+		return mOpt_State != NGame_Optimize_State::Running;
+	};
+
+	if (timeout_ms == Game_Optimize_Wait_Infinite)
+	{
+		mOpt_State_Cv.wait(lck, is_not_running);
+		return true;
+	}
+
+	return mOpt_State_Cv.wait_for(lck, std::chrono::milliseconds(timeout_ms), is_not_running);
+}
+
 DLL_EXPORT scgms_game_optimizer_wrapper_t IfaceCalling scgms_game_optimize(uint16_t config_class, uint16_t config_id, uint32_t stepping_ms, const char* log_file_input_path, const char* log_file_output_path, uint16_t degree_of_opt)
 {
 	std::unique_ptr<CGame_Optimizer_Wrapper> wrapper = std::make_unique<CGame_Optimizer_Wrapper>(stepping_ms, degree_of_opt);
@@ -281,20 +309,18 @@ DLL_EXPORT BOOL IfaceCalling scgms_game_cancel_optimize(scgms_game_optimizer_wra
 	if (wait == FALSE)
 		return TRUE;
 
-	NGame_Optimize_State state;
-	double dummy;
+	wrapper->Wait(Game_Optimize_Wait_Infinite);
 
-	state = wrapper->Get_Progress(dummy);
-	while (state == NGame_Optimize_State::Running)
-	{
-		// this is a kind of an active wait, as it would be implementationally ineffective to implement a conditional variable
-		// the optimizer steals most of the computational resources anyway and is expected to terminate very soon
-		std::this_thread::yield();
+	return TRUE;
+}
 
-		state = wrapper->Get_Progress(dummy);
-	}
+DLL_EXPORT BOOL IfaceCalling scgms_game_wait_optimize(scgms_game_optimizer_wrapper_t wrapper_raw, uint32_t timeout_ms)
+{
+	CGame_Optimizer_Wrapper* wrapper = dynamic_cast<CGame_Optimizer_Wrapper*>(wrapper_raw);
+	if (!wrapper)
+		return FALSE;
 
-	return TRUE;
+	return wrapper->Wait(timeout_ms) ? TRUE : FALSE;
 }
 
 DLL_EXPORT BOOL IfaceCalling scgms_game_optimizer_terminate(scgms_game_optimizer_wrapper_t wrapper_raw)
@@ -49,6 +49,8 @@
 #include <limits>
 #include <mutex>
 #include <thread>
+#include <atomic>
+#include <condition_variable>
 
 // enumeration of optimalization states
 enum class NGame_Optimize_State : size_t
@@ -91,7 +93,11 @@ class CGame_Optimizer_Wrapper : public refcnt::CNotReferenced
 		solver::TSolver_Progress mProgress;
 
 		// optimalization progress state
-		NGame_Optimize_State mOpt_State;
+		std::atomic<NGame_Optimize_State> mOpt_State;
+
+		// mutex and conditional variable to notify waiters about the optimalization end
+		std::mutex mOpt_State_Mtx;
+		std::condition_variable mOpt_State_Cv;
 
 		// identifier of optimized index in optimalization config
 		size_t mOpt_Filter_Idx = 0;
@@ -104,6 +110,9 @@ class CGame_Optimizer_Wrapper : public refcnt::CNotReferenced
 		// thread for optimizer
 		void Optimizer_Thread_Fnc();
 
+		// sets the optimalization state and wakes up all waiters
+		void Set_State(NGame_Optimize_State state);
+
 	public:
 		CGame_Optimizer_Wrapper(uint32_t stepping_ms, uint16_t degree_of_opt);
 
@@ -121,6 +130,9 @@ class CGame_Optimizer_Wrapper : public refcnt::CNotReferenced
 
 		// cancels the optimalization at the closest cancel point
 		bool Request_Cancel();
+
+		// blocks until the optimalization is no longer running or the timeout elapses; returns true if it is no longer running
+		bool Wait(uint32_t timeout_ms);
 };
 
 #pragma warning( pop )
@@ -180,6 +192,24 @@ extern "C" BOOL IfaceCalling scgms_game_get_optimize_status(scgms_game_optimizer
  */
 extern "C" BOOL IfaceCalling scgms_game_cancel_optimize(scgms_game_optimizer_wrapper_t wrapper, BOOL wait);
 
+/*
+ * scgms_game_wait_optimize
+ *
+ * Blocks the calling thread until the optimalization ends (successfully, by failure or by cancellation), or until the timeout elapses.
+ * The thread sleeps while waiting, so it does not steal computational resources from the optimizer.
+ *
+ * Parameters:
+ *		wrapper - pointer to a game optimizer wrapper instance obtained from scgms_game_optimize call
+ *		timeout_ms - maximum time to wait in milliseconds; 0 just polls the state, Game_Optimize_Wait_Infinite waits until the optimalization ends
+ *
+ * Return values:
+ *		TRUE (non-zero) - the optimalization is no longer running; use scgms_game_get_optimize_status to retrieve the resulting state
+ *		FALSE (zero) - the timeout elapsed while the optimalization is still running, or the wrapper is invalid
+ */
+constexpr uint32_t Game_Optimize_Wait_Infinite = std::numeric_limits<uint32_t>::max();
+
+extern "C" BOOL IfaceCalling scgms_game_wait_optimize(scgms_game_optimizer_wrapper_t wrapper, uint32_t timeout_ms);
+
 /*
  * scgms_game_optimizer_terminate
  *
@@ -43,6 +43,13 @@
 #include <scgms/utils/math_utils.h>
 #include <scgms/utils/DebugHelper.h>
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <limits>
+#include <memory>
+
 /*
  * IUnknown bridging functions
  */
@@ -131,6 +138,87 @@ DLL_EXPORT HRESULT IfaceCalling scgms_convert_str_to_wstr(char* str, wchar_t** o
 	return S_OK;
 }
 
+/*
+ * Release of buffers allocated by scgms_extract_*, scgms_convert_str_to_wstr and scgms_optimizer__optimize_parameters
+ */
+
+DLL_EXPORT HRESULT IfaceCalling scgms_free_str(char* str)
+{
+	delete[] str;
+
+	return S_OK;
+}
+
+DLL_EXPORT HRESULT IfaceCalling scgms_free_wstr(wchar_t* str)
+{
+	delete[] str;
+
+	return S_OK;
+}
+
+/*
+ * Borrowed views into live containers; no copy is made
+ * The view holds a reference to the container, so the data stay valid until the matching scgms_release_*_view call,
+ * provided the container is not modified meanwhile. The data are not zero-terminated.
+ */
+
+template<class T>
+HRESULT view_character_container(refcnt::IVector_Container<T>* str, const T** data, size_t* length)
+{
+	if (!str || !data || !length)
+		return E_INVALIDARG;
+
+	T *begin, *end;
+	const HRESULT rc = str->get(&begin, &end);
+	if (rc == S_OK)
+	{
+		*data = begin;
+		*length = static_cast<size_t>(std::distance(begin, end));
+	}
+	else if (rc == S_FALSE)
+	{
+		// empty container
+		*data = nullptr;
+		*length = 0;
+	}
+	else
+		return E_FAIL;
+
+	str->AddRef();
+
+	return S_OK;
+}
+
+DLL_EXPORT HRESULT IfaceCalling scgms_view_str_container(refcnt::str_container *str, const char** data, size_t* length)
+{
+	return view_character_container<char>(str, data, length);
+}
+
+DLL_EXPORT HRESULT IfaceCalling scgms_view_wstr_container(refcnt::wstr_container *str, const wchar_t** data, size_t* length)
+{
+	return view_character_container<wchar_t>(str, data, length);
+}
+
+DLL_EXPORT HRESULT IfaceCalling scgms_release_str_view(refcnt::str_container *str)
+{
+	if (!str)
+		return E_INVALIDARG;
+
+	str->Release();
+
+	return S_OK;
+}
+
+DLL_EXPORT HRESULT IfaceCalling scgms_release_wstr_view(refcnt::wstr_container *str)
+{
+	if (!str)
+		return E_INVALIDARG;
+
+	str->Release();
+
+	return S_OK;
+}
+
 /*
  * SCGMS additions to simple iface
  */
@@ -237,6 +325,131 @@ DLL_EXPORT HRESULT IfaceCalling scgms_optimizer__optimize_parameters(const char*
 	return rc;
 }
 
+/*
+ * Asynchronous optimization jobs
+ *
+ * scgms_optimizer__start_optimize_parameters runs scgms_optimizer__optimize_parameters on its own thread and returns a job handle at once.
+ * scgms_optimizer__wait_optimize_parameters then blocks on a condition variable, instead of polling, until the job ends or the timeout elapses.
+ * scgms_optimizer__cancel_optimize_parameters requests the cancellation and returns at once; wait for the job to learn, when it ends.
+ * scgms_optimizer__release_optimize_parameters cancels a running job, waits for it and frees the handle; the handle must always be released.
+ * The progress instance passed to start must stay valid until the job is released.
+ */
+
+// wait until the job ends, regardless of how long it takes
+constexpr uint32_t Optimizer_Wait_Infinite = std::numeric_limits<uint32_t>::max();
+
+struct TInterop_Optimization_Job
+{
+	// copies of the caller's arguments, as the caller may free them before the job ends
+	std::string config;
+	std::string param_name;
+	uint32_t filter_idx = 0;
+	uint32_t gen_count = 0;
+	uint32_t population_size = 0;
+	solver::TSolver_Progress* progress = nullptr;
+
+	std::thread thread;
+	std::mutex mtx;
+	std::condition_variable cv;
+	bool finished = false;
+
+	HRESULT result = E_FAIL;
+	char* target = nullptr;		// owned by the job until passed out by wait
+};
+
+DLL_EXPORT HRESULT IfaceCalling scgms_optimizer__start_optimize_parameters(const char* config, uint32_t optimizeIdx, const char* optimizeParamName, uint32_t optGenCount, uint32_t optPopulationSize, solver::TSolver_Progress* progress, TInterop_Optimization_Job** job)
+{
+	if (!config || !optimizeParamName || !progress || !job)
+		return E_INVALIDARG;
+
+	auto new_job = std::make_unique<TInterop_Optimization_Job>();
+	new_job->config = config;
+	new_job->param_name = optimizeParamName;
+	new_job->filter_idx = optimizeIdx;
+	new_job->gen_count = optGenCount;
+	new_job->population_size = optPopulationSize;
+	new_job->progress = progress;
+
+	TInterop_Optimization_Job* job_ptr = new_job.get();
+	new_job->thread = std::thread([job_ptr]() {
+		char* target = nullptr;
+		const HRESULT rc = scgms_optimizer__optimize_parameters(job_ptr->config.c_str(), job_ptr->filter_idx, job_ptr->param_name.c_str(), job_ptr->gen_count, job_ptr->population_size, job_ptr->progress, &target);
+
+		{
+			std::unique_lock<std::mutex> lck(job_ptr->mtx);
+			job_ptr->result = rc;
+			job_ptr->target = target;
+			job_ptr->finished = true;
+		}
+
+		job_ptr->cv.notify_all();
+	});
+
+	*job = new_job.release();
+
+	return S_OK;
+}
+
+// returns S_OK and the result of scgms_optimizer__optimize_parameters, if the job ended within the timeout; S_FALSE otherwise
+// the target is passed out just once, and it is to be freed with scgms_free_str
+DLL_EXPORT HRESULT IfaceCalling scgms_optimizer__wait_optimize_parameters(TInterop_Optimization_Job* job, uint32_t timeout_ms, HRESULT* result, char** target)
+{
+	if (!job)
+		return E_INVALIDARG;
+
+	std::unique_lock<std::mutex> lck(job->mtx);
+
+	auto is_finished = [job]() {
+		return job->finished;
+	};
+
+	if (timeout_ms == Optimizer_Wait_Infinite)
+		job->cv.wait(lck, is_finished);
+	else if (!job->cv.wait_for(lck, std::chrono::milliseconds(timeout_ms), is_finished))
+		return S_FALSE;
+
+	if (result)
+		*result = job->result;
+
+	if (target)
+	{
+		*target = job->target;
+		job->target = nullptr;
+	}
+
+	return S_OK;
+}
+
+DLL_EXPORT HRESULT IfaceCalling scgms_optimizer__cancel_optimize_parameters(TInterop_Optimization_Job* job)
+{
+	if (!job)
+		return E_INVALIDARG;
+
+	job->progress->cancelled = TRUE;
+
+	return S_OK;
+}
+
+DLL_EXPORT HRESULT IfaceCalling scgms_optimizer__release_optimize_parameters(TInterop_Optimization_Job* job)
+{
+	if (!job)
+		return E_INVALIDARG;
+
+	{
+		std::unique_lock<std::mutex> lck(job->mtx);
+		if (!job->finished)
+			job->progress->cancelled = TRUE;
+	}
+
+	if (job->thread.joinable())
+		job->thread.join();
+
+	delete[] job->target;
+	delete job;
+
+	return S_OK;
+}
+
 /*
  * Inspection callable bridge functions
  */